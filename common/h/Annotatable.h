@@ -475,9 +475,13 @@ class COMMON_EXPORT AnnotatableDense
 	  }
 };
 
-#define NON_STATIC_SPARSE_MAP 1
 #define AN_INLINE inline
 
+#if defined (_MSC_VER)
+#pragma warning (push)
+#pragma warning (disable:4251)
+#endif
+
 class COMMON_EXPORT AnnotatableSparse
 {
 	friend class SerializerBase;
@@ -486,135 +490,37 @@ class COMMON_EXPORT AnnotatableSparse
 			AnnotatableSparse *, std::vector<ser_rec_t> &);
 
    public:
-      struct void_ptr_hasher
-      {
-         size_t operator()(const void* a) const
-         {
-            return (size_t) a;
-         }
-      };
-
-#if defined (_MSC_VER)
-      typedef dyn_hash_map<void *, void *> annos_by_type_t;
-#pragma warning (push)
-#pragma warning (disable:4251)
-#else
-      typedef dyn_hash_map<void *, void *, void_ptr_hasher> annos_by_type_t;
-#endif
-
-      typedef std::vector<annos_by_type_t *> annos_t;
+      //  (annotation type, annotation) pairs for one object, in type order
+      typedef std::vector<std::pair<AnnotationClassID, void *> > anno_list_t;
 
 	  ~AnnotatableSparse()
 	  {
-		  //  We need to remove annotations from the static map when objects
+		  //  We need to remove annotations from the side table when objects
 		  //  are destroyed:  (1)  memory may be reclaimed and reused at the same
-		  //  place, and (2) regardless of 1, the map can possibly explode to 
-		  //  unmanageable sizes, with a lot of unused junk in it if a lot of i
+		  //  place, and (2) regardless of 1, the table can possibly explode to 
+		  //  unmanageable sizes, with a lot of unused junk in it if a lot of
 		  //  annotatable objects are created and destroyed.
+		  //  All of an object's annotations live in a single record, so this
+		  //  is one lookup in one shard regardless of how many annotation
+		  //  types exist.
 
-		  //  Alas this is kinda expensive right now, but the data structure is
-		  //  set up to minimize search time, not deletion time.  It could
-		  //  be changed if this becomes a significant time drain.
-
-		  unsigned int n = 0;
-		  for (unsigned int i = 0; i < getAnnos()->size(); ++i)
-		  {
-			  annos_by_type_t *abt = (*getAnnos())[i];
-			  if (!abt) continue;
-
-			  annos_by_type_t::iterator iter = abt->find(this);
-			  if (iter != abt->end())
-			  {
-				  if (annotation_debug_flag())
-				  {
-					  fprintf(stderr, "%s[%d]:  Sparse(%p) dtor remove %s-%d\n", FILE__, __LINE__,  
-							  this, AnnotationClassBase::findAnnotationClass(i) 
-							  ? AnnotationClassBase::findAnnotationClass(i)->getName().c_str() 
-							  : "bad_anno_id", i);
-				  }
-
-				  abt->erase(iter);
-				  n++;
-
-				  //  get rid of this check...  just making sure that erase is behaving as
-				  //  expected...
-				  annos_by_type_t::iterator iter2 = abt->find(this);
-				  if (iter2 != abt->end())
-					  fprintf(stderr, "%s[%d]:  FIXME:  REMOVE FAILED\n", FILE__, __LINE__);
-			  }
-		  }
+		  removeAllAnnotations(this);
 	  }
 
    private:
 
-#if defined (NON_STATIC_SPARSE_MAP)
-      //COMMON_EXPORT static annos_t *annos;
-#else
-      static annos_t annos;
-#endif
-	  annos_t *getAnnos() const;
-	  static dyn_hash_map<void *, unsigned short> ser_ndx_map;
-
-      annos_by_type_t *getAnnosOfType(AnnotationClassID aid, bool do_create =false) const
-	  {
-		  annos_t &l_annos = *getAnnos();
-         long nelems_to_create = aid - l_annos.size() + 1;
-
-         if (nelems_to_create > 0)
-         {
-            if (!do_create)
-            {
-               return NULL;
-            }
-
-            while (nelems_to_create)
-            {
-               annos_by_type_t *newl = new annos_by_type_t();
-               l_annos.push_back(newl);
-               nelems_to_create--;
-            }
-         }
-
-         annos_by_type_t *abt = l_annos[aid];
-
-         return abt;
-      }
-
-      template <class T>
-      AN_INLINE annos_by_type_t *getAnnosOfType(AnnotationClass<T> &a_id, bool do_create =false) const
-      {
-         AnnotationClassID aid = a_id.getID();
-
-		 return getAnnosOfType(aid, do_create);
-	  }
-
-
-      void *getAnnosForObject(annos_by_type_t *abt,
-            void *obj, bool do_create = false) const 
-      {
-         assert(abt);
-         assert(obj);
-
-         void  *target = NULL;
-
-         annos_by_type_t::iterator iter = abt->find(obj);
-
-         if (iter == abt->end())
-         {
-            if (!do_create)
-            {
-               return NULL;
-            }
-
-            (*abt)[obj] = target;
-         }
-         else
-         {
-            target = iter->second;
-         }
-
-         return target;
-      }
+	  //  The side table is split into independently locked shards keyed by
+	  //  object address; each annotated object owns one record holding all of
+	  //  its annotations and its serializer index.  See Annotatable.C.
+	  static void *findAnnotation(const void *obj, AnnotationClassID aid);
+	  //  Returns true if obj had no annotation of this type; ser_ndx gets the
+	  //  object's serializer index (or -1)
+	  static bool storeAnnotation(const void *obj, AnnotationClassID aid, void *a,
+			  unsigned short &ser_ndx);
+	  static bool eraseAnnotation(const void *obj, AnnotationClassID aid);
+	  static void removeAllAnnotations(const void *obj);
+	  static void getAllAnnotations(const void *obj, anno_list_t &annos);
+	  static void setSerializerIndex(const void *obj, unsigned short ser_ndx);
 
 	  //  private version of addAnnotation used by deserialize function to restore
 	  //  annotation set without explicitly specifying types
@@ -628,35 +534,8 @@ class COMMON_EXPORT AnnotatableSparse
 					  : "bad_anno_id", aid);
 		  }
 
-		  void *obj = this;
-		  annos_by_type_t *abt = getAnnosOfType(aid, true /*do create if needed*/);
-		  assert(abt);
-
-		  annos_by_type_t::iterator iter = abt->find(obj);
-		  if (iter == abt->end())
-		  {
-			  (*abt)[obj] = const_cast<void *>(a);
-		  }
-		  else
-		  {
-			  //  do silent replacement -- this case can arise if an annotatable object
-			  //  is destroyed and then reallocated as a new object at the same address.
-			  //  Given the sparse map data structure, it would be rather expensive to 
-			  //  go through the map in the dtor to eliminate references to the 
-			  //  destroyed object.
-
-			  //  Added annotation removal in dtor...  so this case should _not_ arise,
-			  //  do the replacement, but make some noise:
-
-			  if (a != iter->second)
-			  {
-				  annotatable_printf("%s[%d]:  WEIRD:  already have annotation of this type: %p, replacing with %p\n", FILE__, __LINE__, iter->second, a);
-				  iter->second = const_cast<void *>(a);
-			  }
-
-			  return true;
-		  }
-
+		  unsigned short ser_ndx;
+		  storeAnnotation(this, aid, const_cast<void *>(a), ser_ndx);
 		  return true;
 	  }
 
@@ -664,148 +543,80 @@ class COMMON_EXPORT AnnotatableSparse
 
 	  bool operator==(AnnotatableSparse &cmp)
 	  {
-		  annos_t &l_annos = *getAnnos();
-		  unsigned this_ntypes = l_annos.size();
-         unsigned cmp_ntypes = cmp.getAnnos()->size();
-         unsigned ntypes = (cmp_ntypes > this_ntypes) ? cmp_ntypes : this_ntypes;
+		  anno_list_t this_annos, cmp_annos;
+		  getAllAnnotations(this, this_annos);
+		  getAllAnnotations(&cmp, cmp_annos);
 
-         for (unsigned int i = 0; i < ntypes; ++i) 
-         {
-            if ((i >= cmp_ntypes) || (i >= this_ntypes)) 
-            {
-               //  compare is done since at least one set of annotations
-               //  has been exhausted
-               break;
-            }
-
-            annos_by_type_t *this_abt = l_annos[i];
-            annos_by_type_t *cmp_abt = (*cmp.getAnnos())[i];
-
-            if (!this_abt) 
-            {
-               fprintf(stderr, "%s[%d]:  WEIRD: FIXME\n", FILE__, __LINE__);
-               continue;
-            }
-
-            if (!cmp_abt) 
-            {
-               fprintf(stderr, "%s[%d]:  WEIRD: FIXME\n", FILE__, __LINE__);
-               continue;
-            }
-
-            annos_by_type_t::iterator this_abt_iter = this_abt->find(this);
-            annos_by_type_t::iterator cmp_abt_iter = cmp_abt->find(&cmp);
-
-            //  if one has annotations of this particular type and other other
-            //  doesn't, then we are def. not equal, so fail:
-
-            if (this_abt_iter == this_abt->end())
-            {
-               if (cmp_abt_iter != cmp_abt->end())
-               {
-                  return false;
-               }
-
-               //  both are at end()
-               continue;
-            }
-
-            if (   (cmp_abt_iter == cmp_abt->end())
-                  && (this_abt_iter != this_abt->end()))
-            {
-               return false;
-            }
-
-            AnnotationClassBase *acb = AnnotationClassBase::findAnnotationClass(i);
-
-            if (!acb)
-            {
-               return false;
-            }
-
-            //  both have annotation -- do the compare
-            anno_cmp_func_t cmpfunc = acb->getCmpFunc();
-
-            if (!cmpfunc)
-            {
-               //  even if not explicitly specified, a default pointer-compare
-               //  function should be returned here.
-
-               fprintf(stderr, "%s[%d]:  no cmp func for anno id %d\n", 
-                     FILE__, __LINE__, i);
-               return false;
-            }
-
-            void *arg1 = cmp_abt_iter->second;
-            void *arg2 = this_abt_iter->second;
-
-            bool ret = (*cmpfunc)(arg1, arg2);
-
-            return ret;
-         }
+		  //  Only the lowest annotation type either object carries decides
+		  //  the compare
+		  if (this_annos.empty() && cmp_annos.empty())
+			  return true;
+		  if (this_annos.empty() || cmp_annos.empty())
+			  return false;
+		  if (this_annos[0].first != cmp_annos[0].first)
+			  return false;
 
-         return true;
-      }
+		  AnnotationClassID id = this_annos[0].first;
+		  AnnotationClassBase *acb = AnnotationClassBase::findAnnotationClass(id);
+
+		  if (!acb)
+		  {
+			  return false;
+		  }
+
+		  //  both have annotation -- do the compare
+		  anno_cmp_func_t cmpfunc = acb->getCmpFunc();
+
+		  if (!cmpfunc)
+		  {
+			  //  even if not explicitly specified, a default pointer-compare
+			  //  function should be returned here.
+
+			  fprintf(stderr, "%s[%d]:  no cmp func for anno id %d\n", 
+					  FILE__, __LINE__, id);
+			  return false;
+		  }
+
+		  return (*cmpfunc)(cmp_annos[0].second, this_annos[0].second);
+	  }
 
       template<class T>
       AN_INLINE bool addAnnotation(const T *a, AnnotationClass<T> &a_id)
          {
 		  annotatable_printf("%s[%d]:  Sparse(%p):  Add %s-%d, %s\n", FILE__, __LINE__, 
 				  this, a_id.getName().c_str(), a_id.getID(), typeid(T).name());
-            void *obj = this;
-            annos_by_type_t *abt = getAnnosOfType(a_id, true /*do create if needed*/);
-            assert(abt);
-
-            annos_by_type_t::iterator iter = abt->find(obj);
-            if (iter == abt->end())
-            {
-               (*abt)[obj] = (void *) const_cast<T *>(a);
-            }
-            else
-            {
-				//  do silent replacement -- this case can arise if an annotatable object
-				//  is destroyed and then reallocated as a new object at the same address.
-				//  Given the sparse map data structure, it would be rather expensive to 
-				//  go through the map in the dtor to eliminate references to the 
-				//  destroyed object.
-
-				//  Added annotation removal in dtor...  so this case should _not_ arise,
-				//  do the replacement, but make some noise:
-
-				if (iter->second != a) 
-				{
-					//fprintf(stderr, "%s[%d]:  WEIRD:  already have annotation of type %s: %p, replacing with %p\n", FILE__, __LINE__, a_id.getName().c_str(), iter->second, a);
-					iter->second = (void *)const_cast<T *>(a);
-				}
 
+			//  An existing annotation of this type is silently replaced; the
+			//  dtor removes annotations, so this should only happen if a
+			//  caller re-annotates deliberately.
+			unsigned short ser_ndx;
+			if (!storeAnnotation(this, a_id.getID(), (void *) const_cast<T *>(a), ser_ndx))
+			{
 				return true;
-            }
+			}
 
 #if !defined(SERIALIZATION_DISABLED)
-			dyn_hash_map<void *, unsigned short>::iterator seriter;
-			seriter = ser_ndx_map.find(this);
-			if (seriter != ser_ndx_map.end())
+			if (ser_ndx != (unsigned short) -1)
 			{
-				if (seriter->second != (unsigned short) -1)
+				SerializerBase *sb = getExistingOutputSB(ser_ndx);
+				if (!sb)
 				{
-					SerializerBase *sb = getExistingOutputSB(seriter->second);
-					if (!sb)
-					{
-						fprintf(stderr, "%s[%d]:  FIXME:  no existing output SB\n", 
-								FILE__, __LINE__);
-						return false;
-					}
+					fprintf(stderr, "%s[%d]:  FIXME:  no existing output SB\n", 
+							FILE__, __LINE__);
+					return false;
+				}
 
-					ser_func_t sf = a_id.getSerializeFunc();
-					if (sf)
-					{
-						ser_post_op_t op = sp_add_anno;
-						ser_operation(sb, op, "AnnotationAdd");
-						void *aa = (void *) const_cast<T *>(a);
-						serialize_post_annotation(this, aa, sb, &a_id, sparse, "PostAnnotation");
-					}
+				ser_func_t sf = a_id.getSerializeFunc();
+				if (sf)
+				{
+					ser_post_op_t op = sp_add_anno;
+					ser_operation(sb, op, "AnnotationAdd");
+					void *aa = (void *) const_cast<T *>(a);
+					serialize_post_annotation(this, aa, sb, &a_id, sparse, "PostAnnotation");
 				}
 			}
+#else
+			(void) ser_ndx;
 #endif
 				
             return true;
@@ -814,26 +625,8 @@ class COMMON_EXPORT AnnotatableSparse
       template<class T>
       AN_INLINE bool getAnnotation(T *&a, AnnotationClass<T> &a_id) const 
       {
-         a = NULL;
-
-         annos_by_type_t *abt = getAnnosOfType(a_id, false /*don't create if none*/);
-
-         if (!abt)
-         {
-            return false;
-         }
-
-         AnnotatableSparse * this_noconst = const_cast<AnnotatableSparse *>(this);
-         void *annos_for_object = getAnnosForObject(abt, (void *)this_noconst,
-               false /*no create if none*/);
-
-         if (!annos_for_object)
-         {
-            return false;
-         }
-
-         a = (T *)annos_for_object;
-         return true;
+         a = (T *) findAnnotation(this, a_id.getID());
+         return (a != NULL);
       }
 
 	  template<class T>
@@ -845,43 +638,20 @@ class COMMON_EXPORT AnnotatableSparse
 					  this, a_id.getName().c_str(), a_id.getID(), typeid(T).name());
 		  }
 
-		  void *obj = this;
-		  annos_by_type_t *abt = getAnnosOfType(a_id, false /*do create if needed*/);
-		  assert(abt);
-
-		  annos_by_type_t::iterator iter = abt->find(obj);
-		  if (iter == abt->end())
-		  {
-			  //  annotation does not exist, so we return false (remove failed)
-			  return false;
-		  }
-		  else
-		  {
-			  abt->erase(iter);
-			  return true;
-		  }
-	      return false;
+		  //  returns false (remove failed) if the annotation does not exist
+		  return eraseAnnotation(this, a_id.getID());
 	  }
 
     void serializeAnnotations(SerializerBase *sb, const char *)
 	  {
-		  annos_t &l_annos = *getAnnos();
 		  std::vector<ser_rec_t> my_sers;
-            void *obj = this;
 			if (is_output(sb))
 			{
-				for (AnnotationClassID id = 0; id < l_annos.size(); ++id)
+				anno_list_t annos;
+				getAllAnnotations(this, annos);
+				for (unsigned int i = 0; i < annos.size(); ++i)
 				{
-					annos_by_type_t *abt = getAnnosOfType(id, false /*don't do create */);
-					if (NULL == abt) continue;
-
-					annos_by_type_t::iterator iter = abt->find(obj);
-
-					if (iter == abt->end()) 
-					{
-						//	fprintf(stderr, "%s[%d]:  nothing for this obj\n", FILE__, __LINE__);
-						continue;
-					}
+					AnnotationClassID id = annos[i].first;
 
 					//  we have an annotation of this type for this object, find the serialization
 					//  function and call it (if it exists)
@@ -902,13 +672,13 @@ class COMMON_EXPORT AnnotatableSparse
 
 					ser_rec_t sr;
 					sr.acb = acb;
-					sr.data = iter->second;
+					sr.data = annos[i].second;
 					sr.parent_id = (void *) this;
 					sr.sod = sparse;
 					my_sers.push_back(sr);
 				}
 
-					ser_ndx_map[this] = get_serializer_index(sb);
+				setSerializerIndex(this, get_serializer_index(sb));
 			}
 
 #if !defined(SERIALIZATION_DISABLED)
@@ -929,21 +699,12 @@ class COMMON_EXPORT AnnotatableSparse
 	  void annotationsReport()
 	  {
 		  std::vector<AnnotationClassBase *> atypes;
-		  annos_t &l_annos = *getAnnos();
+		  anno_list_t annos;
+		  getAllAnnotations(this, annos);
 
-		  for (AnnotationClassID id = 0; id < l_annos.size(); ++id)
+		  for (unsigned int i = 0; i < annos.size(); ++i)
 		  {
-			  annos_by_type_t *abt = getAnnosOfType(id, false /*don't do create */);
-			  if (NULL == abt) continue;
-
-			  annos_by_type_t::iterator iter = abt->find(this);
-
-			  if (iter == abt->end()) 
-			  {
-				  //	fprintf(stderr, "%s[%d]:  nothing for this obj\n", FILE__, __LINE__);
-				  continue;
-			  }
-
+			  AnnotationClassID id = annos[i].first;
 			  AnnotationClassBase *acb =  AnnotationClassBase::findAnnotationClass(id);
 			  if (!acb)
 			  {
@@ -38,6 +38,7 @@
 #include <assert.h>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace Dyninst
 {
@@ -117,6 +118,9 @@ namespace Dyninst
         int getDwarfEnc() const;
 
         static MachRegister getArchReg(unsigned int regNum, Dyninst::Architecture arch);
+
+        // Appends every named register of the given architecture to regs
+        static void getAllRegisters(Dyninst::Architecture arch, std::vector<MachRegister> &regs);
    };
 
    /**
@@ -975,6 +975,58 @@ ia32_decode_opcode(unsigned int capa, const unsigned char *addr, ia32_instructio
 COMMON_EXPORT ia32_instruction &
 ia32_decode(unsigned int capabilities, const unsigned char *addr, ia32_instruction &, bool mode_64);
 
+/* Operand read/write semantics of the sXXX operand semantic values above */
+COMMON_EXPORT bool ia32_reads_operand(unsigned int sema, unsigned int i);
+COMMON_EXPORT bool ia32_writes_operand(unsigned int sema, unsigned int i);
+
+/*
+ * A flat, plain-old-data summary of a decoded instruction. Unlike an
+ * InstructionAPI Instruction it owns no expression trees or register sets,
+ * so it can be filled in for every byte of a large binary without touching
+ * the heap. Registers are recorded as bitmasks indexed by the ISA encoding
+ * of the general purpose registers (0 = (R|E)AX ... 15 = R15); the
+ * IA32_FLAT_RIP and IA32_FLAT_FLAGS bits cover the instruction pointer and
+ * the flags register. Sub-registers (AL, AH, AX) map onto their full
+ * register.
+ */
+#define IA32_FLAT_RIP   (1U << 16)
+#define IA32_FLAT_FLAGS (1U << 17)
+
+struct ia32_flat_operand
+{
+  unsigned int admet;   // addressing method (am_*)
+  unsigned int optype;  // operand type (op_*), or the register for am_reg
+  bool read;
+  bool written;
+  bool implicit;
+  bool memory;          // operand is a memory reference
+  int reg;              // GPR number if the operand is a GPR, -1 otherwise
+};
+
+struct ia32_flat_instruction
+{
+  bool valid;
+  unsigned int size;
+  entryID id;
+  unsigned int legacy_type;
+  const ia32_entry *entry;   // table entry; feed to the full decoder if needed
+  unsigned int num_operands;
+  ia32_flat_operand operands[4];
+  bool rip_relative;
+  unsigned int regs_read;
+  unsigned int regs_written;
+  ia32_locations loc;
+};
+
+/*
+ * Decode the instruction at addr into a flat record. addr must have at least
+ * the maximum instruction length (16 bytes) readable. Returns false if the
+ * bytes do not form a valid instruction; size is still set so that callers
+ * can step over them.
+ */
+COMMON_EXPORT bool
+ia32_decode_flat(const unsigned char *addr, ia32_flat_instruction &out, bool mode_64);
+
 
 enum dynamic_call_address_mode {
   REGISTER_DIRECT, REGISTER_INDIRECT,
@@ -94,6 +94,9 @@ public:
 	}
 	bool query(ParseAPI::Location loc, Type type, const MachRegister &machReg, bool& live);
 	bool query(ParseAPI::Location loc, Type type, bitArray &bitarray);
+	// Union of the registers func writes anywhere in its body; calls,
+	// tail calls and syscalls contribute their ABI clobber sets.
+	bool queryDefined(ParseAPI::Function *func, bitArray &bitarray);
 
 	ErrorType getLastError(){ return errorno; }
 
@@ -39,6 +39,8 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 // To define StackAST
 #include "DynAST.h"
@@ -515,6 +517,14 @@ public:
    DATAFLOW_EXPORT bool canGetFunctionSummary();
    DATAFLOW_EXPORT bool getFunctionSummary(TransferSet &summary);
 
+   // Analyzes each of the given functions and annotates them with the results,
+   // running the analyses concurrently when built with OpenMP.  Later queries
+   // on these functions are then answered from the annotations.  Functions
+   // whose analysis fails are appended to failed; returns false if any did.
+   DATAFLOW_EXPORT static bool analyzeFunctions(
+      const std::vector<ParseAPI::Function *> &funcs,
+      std::vector<ParseAPI::Function *> &failed);
+
    DATAFLOW_EXPORT void debug();
 
 private:
@@ -529,6 +539,7 @@ private:
    void summarizeBlocks(bool verbose = false);
    void summarize();
 
+   void numberBlocks();
    void fixpoint(bool verbose = false);
    void summaryFixpoint();
 
@@ -536,17 +547,13 @@ private:
 
    void createEntryInput(AbslocState &input);
    void createSummaryEntryInput(TransferSet &input);
-   void meetInputs(ParseAPI::Block *b, AbslocState& blockInput,
-      AbslocState &input);
-   void meetSummaryInputs(ParseAPI::Block *b, TransferSet &blockInput,
-      TransferSet &input);
+   void meetInputs(unsigned id, AbslocState &input);
+   void meetSummaryInputs(unsigned id, TransferSet &input);
    DefHeight meetDefHeight(const DefHeight &dh1, const DefHeight &dh2);
    DefHeightSet meetDefHeights(const DefHeightSet &s1,
       const DefHeightSet &s2);
    void meet(const AbslocState &source, AbslocState &accum);
    void meetSummary(const TransferSet &source, TransferSet &accum);
-   AbslocState getSrcOutputLocs(ParseAPI::Edge* e);
-   TransferSet getSummarySrcOutputLocs(ParseAPI::Edge *e);
    void computeInsnEffects(ParseAPI::Block *block, InstructionAPI::Instruction insn,
                            const Offset off, TransferFuncs &xferFunc, TransferSet &funcSummary);
 
@@ -621,13 +628,21 @@ private:
    InstructionEffects *insnEffects;  // Pointer so we can make it an annotation
    CallEffects *callEffects;  // Pointer so we can make it an annotation
 
-   BlockState blockInputs;
-   BlockState blockOutputs;
+   // Blocks reachable from the entry over intraprocedural edges, numbered
+   // densely in reverse postorder.  The fixpoint state below is indexed by
+   // these numbers rather than keyed by Block *.
+   std::vector<ParseAPI::Block *> blockOrder;
+   std::unordered_map<ParseAPI::Block *, unsigned> blockIds;
+   std::vector<std::vector<unsigned> > blockPreds;
+   std::vector<std::vector<unsigned> > blockSuccs;
+
+   std::vector<AbslocState> blockInputs;
+   std::vector<AbslocState> blockOutputs;
 
    // Like blockInputs and blockOutputs, but used for function summaries.
    // Instead of tracking Heights, we track transfer functions.
-   BlockSummaryState blockSummaryInputs;
-   BlockSummaryState blockSummaryOutputs;
+   std::vector<TransferSet> blockSummaryInputs;
+   std::vector<TransferSet> blockSummaryOutputs;
 
    Intervals *intervals_; // Pointer so we can make it an annotation
 
@@ -101,6 +101,42 @@ private:
 
     void setupCFIData();
 
+    // The unwind rules of one CFI row, reduced to the forms compilers
+    // emit for ordinary frames.  Anything else is left to the general
+    // expression evaluator.
+    struct FrameRule {
+        typedef enum {
+            rule_expression,     // evaluate the DWARF expression
+            rule_same_value,     // undefined or same_value
+            rule_reg_offset,     // reg + offset
+            rule_at_reg_offset,  // *(reg + offset)
+            rule_cfa_offset,     // CFA + offset
+            rule_at_cfa_offset   // *(CFA + offset)
+        } kind_t;
+        kind_t kind;
+        int reg;                 // DWARF register number, reg_ rules only
+        Dwarf_Sword offset;
+    };
+
+    // CFA, return address and frame pointer rules over [low, high)
+    struct FrameRow {
+        Address low;
+        Address high;
+        FrameRule cfa;
+        FrameRule ra;
+        FrameRule fp;
+    };
+
+    bool findFrameRow(Address pc, FrameRow &row);
+    bool decodeFrameRow(Address pc, FrameRow &row);
+    static void decodeFrameRule(Dwarf_Op *ops, size_t nops, bool is_cfa, FrameRule &rule);
+    bool evalFrameRule(const FrameRow &row,
+            const FrameRule &rule,
+            MachRegister reg,
+            MachRegisterVal &val,
+            ProcessReader *reader,
+            FrameErrors_t &err_result);
+
     struct frameParser_key
     {
         Dwarf * dbg;
@@ -156,6 +192,13 @@ private:
     dyn_mutex cfi_lock;
     std::vector<Dwarf_CFI *> cfi_data;
 
+    // DWARF number of the architecture's frame pointer, or -1
+    int fp_dwarf_reg;
+
+    // Rows decoded so far, sorted by low and non-overlapping
+    dyn_rwlock rows_lock;
+    std::vector<FrameRow> frame_rows;
+
 };
 
 }
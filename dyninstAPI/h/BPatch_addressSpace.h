@@ -73,6 +73,7 @@ class BPatch_snippet;
 class BPatch_point;
 class BPatch_variableExpr;
 class BPatch_type;
+class BPatch_shardedCounter;
 class AddressSpace;
 class miniTrampHandle;
 class miniTramp;
@@ -377,6 +378,15 @@ class BPATCH_DLL_EXPORT BPatch_addressSpace {
   
   bool free(BPatch_variableExpr &ptr);
 
+  //  BPatch_addressSpace::createShardedCounter
+  //
+  //  Allocate a counter with numSlots per-thread slots, each slotStride
+  //  bytes apart and aligned to slotStride, in the mutatee process
+
+  BPatch_shardedCounter * createShardedCounter(unsigned numSlots = 64,
+                                               unsigned slotStride = 64,
+                                               std::string name = std::string(""));
+
   // BPatch_addressSpace::createVariable
   // 
   // Wrap an existing piece of allocated memory with a BPatch_variableExpr.
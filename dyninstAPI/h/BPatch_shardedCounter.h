@@ -0,0 +1,91 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _BPatch_shardedCounter_h_
+#define _BPatch_shardedCounter_h_
+
+#include <vector>
+#include "BPatch_dll.h"
+#include "BPatch_snippet.h"
+
+class BPatch_addressSpace;
+class BPatch_variableExpr;
+
+/*
+ * A counter split into per-thread slots in the mutatee.  Each slot lives
+ * on its own cache line so that instrumentation running on different
+ * threads never contends for the same line; the mutator sums the slots
+ * when it wants the total.  Created by
+ * BPatch_addressSpace::createShardedCounter.
+ */
+class BPATCH_DLL_EXPORT BPatch_shardedCounter {
+    friend class BPatch_addressSpace;
+
+    BPatch_addressSpace *addSpace_;
+    BPatch_variableExpr *storage_;
+    BPatch_variableExpr *slots_;
+    unsigned numSlots_;
+    unsigned slotStride_;
+    unsigned wordSize_;
+
+    BPatch_shardedCounter(BPatch_addressSpace *addSpace,
+                          BPatch_variableExpr *storage,
+                          BPatch_variableExpr *slots,
+                          unsigned numSlots,
+                          unsigned slotStride,
+                          unsigned wordSize);
+
+public:
+    //  BPatch_shardedCounter::incrementExpr
+    //  Snippet adding amount to the executing thread's slot
+    BPatch_threadCounterExpr incrementExpr(long amount = 1);
+
+    //  BPatch_shardedCounter::getValue
+    //  Sum of all slots; only available for a running process
+    bool getValue(long &total);
+
+    //  BPatch_shardedCounter::getSlotValues
+    //  Per-slot values, indexed by thread index modulo numSlots()
+    bool getSlotValues(std::vector<long> &values);
+
+    //  BPatch_shardedCounter::reset
+    //  Zero every slot
+    bool reset();
+
+    unsigned numSlots() const { return numSlots_; }
+    unsigned slotStride() const { return slotStride_; }
+
+    //  BPatch_shardedCounter::getStorage
+    //  The underlying allocation; pass to BPatch_addressSpace::free when
+    //  the counter is no longer instrumented
+    BPatch_variableExpr *getStorage() const { return storage_; }
+};
+
+#endif /* _BPatch_shardedCounter_h_ */
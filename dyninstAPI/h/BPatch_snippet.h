@@ -369,6 +369,7 @@ class BPATCH_DLL_EXPORT BPatch_variableExpr : public BPatch_snippet
     friend class BPatch_binaryEdit;
     friend class BPatch_image;
     friend class BPatch_function;
+    friend class BPatch_threadCounterExpr;
 
     std::string		name;
     BPatch_addressSpace     *appAddSpace;
@@ -554,6 +555,22 @@ class BPATCH_DLL_EXPORT BPatch_threadIndexExpr : public BPatch_snippet {
   BPatch_threadIndexExpr();
 };
 
+class BPATCH_DLL_EXPORT BPatch_threadCounterExpr : public BPatch_snippet {
+ public:
+  //
+  // BPatch_threadCounterExpr::BPatch_threadCounterExpr
+  //  Add amount to the executing thread's slot of a per-thread counter
+  //  array.  counters must hold numSlots mutatee longs spaced slotStride bytes
+  //  apart; the default stride keeps each slot on its own cache line.
+  //  Threads whose index is numSlots or more share slots (index modulo
+  //  numSlots); the add is atomic where the platform supports it.
+  //  See also BPatch_shardedCounter, which manages the storage.
+  BPatch_threadCounterExpr(BPatch_variableExpr &counters,
+                           unsigned numSlots,
+                           unsigned slotStride = 64,
+                           long amount = 1);
+};
+
 class BPATCH_DLL_EXPORT BPatch_tidExpr : public BPatch_snippet {
  public:
   //
@@ -39,6 +39,8 @@
 #include "dyninstAPI/src/Relocation/CodeMover.h"
 #include "RelocEdge.h"
 
+#include <atomic>
+
 class baseTramp;
 class block_instance;
 class func_instance;
@@ -67,7 +69,9 @@ class RelocBlock {
 
  public:
    typedef int Label;
-   static int RelocBlockID;
+   // RelocBlocks may be created from several threads (see
+   // CodeMover::addFunctions); IDs are only used for debugging output.
+   static std::atomic<int> RelocBlockID;
    typedef std::list<WidgetPtr> WidgetList;
    typedef enum {
       Relocated,
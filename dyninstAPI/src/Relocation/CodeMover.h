@@ -36,6 +36,7 @@
 #include "common/src/Types.h"
 #include <list>
 #include <map>
+#include <vector>
 #include "dyninstAPI/src/codegen.h" // codeGen structure
 
 #include "Transformers/Transformer.h"
@@ -132,10 +133,18 @@ class CodeMover {
   CodeMover(CodeTracker *t);
   
   void setAddr(Address &addr) { addr_ = addr; }
-  template <typename RelocBlockIter>
-     bool addRelocBlocks(RelocBlockIter begin, RelocBlockIter end, func_instance *f);
-
-  bool addRelocBlock(block_instance *block, func_instance *f);
+  struct RelocWorkItem {
+     RelocWorkItem(block_instance *b, func_instance *f, RelocBlock *r)
+        : block(b), func(f), reloc(r) {}
+     block_instance *block;
+     func_instance *func;
+     RelocBlock *reloc;
+  };
+  typedef std::vector<RelocWorkItem> RelocWork;
+
+  void createRelocBlocks(RelocWork &work);
+
+  bool addRelocBlock(block_instance *block, func_instance *f, RelocBlock *reloc);
 
   void finalizeRelocBlocks();
 
@@ -265,6 +265,8 @@ class CodeTracker {
 
   const TrackerList &trackers() { return trackers_; }
 
+  static void fillRelocInfo(TrackerElement *e, Address relocAddr, RelocInfo &ri);
+
  private:
 
   // We make this block specific to handle shared
@@ -275,6 +277,44 @@ class CodeTracker {
   TrackerList trackers_;
 };
 
+// One sorted index over every CodeTracker in an address space, so that
+// translating an address is a binary search instead of a lookup in each
+// relocation round's maps. Relocated ranges never overlap, so the
+// reverse direction is a flat array sorted by start; the forward
+// direction maps an original address to the trackers that relocated it.
+class RelocIndex {
+ public:
+  RelocIndex() : numTrackers_(0) {};
+
+  // Merge in a tracker whose indices have been built
+  void add(CodeTracker *ct);
+  void clear();
+
+  TrackerElement *findByReloc(Address relocAddr) const;
+  bool relocToOrig(Address relocAddr, CodeTracker::RelocInfo &ri) const;
+
+  // Trackers with a forward mapping for origAddr, oldest first
+  void trackersByOrig(Address origAddr, std::vector<CodeTracker *> &ret) const;
+
+ private:
+  struct OrigEntry {
+     Address orig;
+     unsigned seq;
+     CodeTracker *ct;
+     bool operator<(const OrigEntry &o) const {
+        return (orig < o.orig) || (orig == o.orig && seq < o.seq);
+     }
+  };
+
+  // Kept as separate arrays so the search only touches the starts
+  std::vector<Address> relocStarts_;
+  std::vector<Address> relocEnds_;
+  std::vector<TrackerElement *> relocElems_;
+
+  std::vector<OrigEntry> orig_;
+  unsigned numTrackers_;
+};
+
 };
 };
 
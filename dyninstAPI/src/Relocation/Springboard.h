@@ -33,12 +33,14 @@
 #if !defined(_R_SPRINGBOARD_H_)
 #define _R_SPRINGBOARD_H_
 #include <map>
+#include <vector>
 #include "common/src/IntervalTree.h"
 #include "common/h/dyntypes.h"
 #include "Transformers/Transformer.h" // Priority enum
 #include "dyninstAPI/src/codegen.h"
 
 class AddressSpace;
+class mapped_object;
 
 class func_instance;
 
@@ -219,6 +221,19 @@ struct SpringboardInfo {
     SpringboardInfo(int v, func_instance* f, Priority p) : val(v), func(f), priority(p) {}
 };
 
+// Per-binary accounting of how springboards were installed. A trap is
+// "avoided" when the springboard only fit by using NOP padding after
+// a block or by hopping through dead bytes of a nearby block.
+struct SpringboardStats {
+    unsigned branches;
+    unsigned traps;
+    unsigned paddingBranches;
+    unsigned multiHops;
+
+    SpringboardStats() : branches(0), traps(0), paddingBranches(0), multiHops(0) {}
+    unsigned trapsAvoided() const { return paddingBranches + multiHops; }
+};
+
 class InstalledSpringboards
 {
  public:
@@ -242,6 +257,25 @@ class InstalledSpringboards
     return relocTraps_.find(a) != relocTraps_.end();
   }
 
+  // Dead bytes in original code that a multi-hop springboard may use:
+  // the tail of a block whose entry already got a springboard. Bytes still
+  // held by an installed hop or branch are left out.
+  void addScratch(Address start, Address end);
+  void scratchNear(Address lo, Address hi, std::vector<std::pair<Address, Address> > &ranges);
+  void consumeScratch(Address start, Address end);
+  bool usesPadding(Address start, Address end);
+
+  // The intermediate branch used by a multi-hop springboard, so that
+  // reinstrumentation can reuse it.
+  bool findHop(Address from, Address &hop, Address &hopEnd);
+  void registerHop(Address from, Address hop, Address hopEnd);
+  // True if [hop, hopEnd) overlaps a hop belonging to a springboard other
+  // than the one at from.
+  bool hopTaken(Address from, Address hop, Address hopEnd);
+
+  SpringboardStats &stats(mapped_object *obj) { return stats_[obj]; }
+  const std::map<mapped_object *, SpringboardStats> &allStats() const { return stats_; }
+
     
   
  private:
@@ -264,6 +298,16 @@ class InstalledSpringboards
   // to, since relocation size is >= original size. However, we still don't
   // want overlapping branches. 
   IntervalTree<Address, SpringboardInfo*> overwrittenRelocatedCode_;
+
+  // Start -> end of each scratch range
+  std::map<Address, Address> scratch_;
+  // Springboard address -> [start, end) of its hop
+  std::map<Address, std::pair<Address, Address> > hops_;
+  // Hop start -> (hop end, springboard address); the inverse of hops_
+  std::map<Address, std::pair<Address, Address> > hopOwners_;
+
+  std::map<mapped_object *, SpringboardStats> stats_;
+
   void debugRanges();
   
 };
@@ -296,8 +340,18 @@ class SpringboardBuilder {
 				       const SpringboardReq &p,
                                        SpringboardMap &);
 
-  bool generateMultiSpringboard(std::list<codeGen> &input,
-				const SpringboardReq &p);
+  generateResult_t generateMultiSpringboard(std::list<codeGen> &input,
+                                            const SpringboardReq &p);
+  bool generateHop(std::list<codeGen> &input,
+                   const SpringboardReq &p,
+                   Address hop,
+                   Address limit,
+                   unsigned shortSize);
+  generateResult_t generateTrapSpringboard(std::list<codeGen> &input,
+                                           const SpringboardReq &p);
+  void addBlockScratch(const SpringboardReq &p, unsigned size);
+  SpringboardStats &stats(const SpringboardReq &p);
+  void reportStats();
 
   // Find all previous instrumentations and also overwrite 
   // them. 
@@ -308,8 +362,6 @@ class SpringboardBuilder {
 			    bool useTrap);
 
 
-  void addMultiNeeded(const SpringboardReq &p);
-
   void generateBranch(Address from, Address to, codeGen &input);
   void generateTrap(Address from, Address to, codeGen &input);
 
@@ -320,15 +372,10 @@ class SpringboardBuilder {
     return installed_springboards_->registerBranch(start, end, dest, inRelocatedCode, func, p);
   }
 
-  bool isLegalShortBranch(Address from, Address to);
-  Address shortBranchBack(Address from);
-
 
   AddressSpace *addrSpace_;
 
   InstalledSpringboards::Ptr installed_springboards_;
-  
-  std::list<SpringboardReq> multis_;
 
 };
 
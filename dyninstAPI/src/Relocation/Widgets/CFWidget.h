@@ -221,6 +221,7 @@ struct CFPatch : public Patch {
   Address origAddr_;  
   arch_insn *ugly_insn;
   unsigned char* insn_ptr;
+  PatchCache cache;
 
 
 #if defined(arch_power)
@@ -234,6 +235,7 @@ struct CFPatch : public Patch {
   private:
   bool isPLT(codeGen &gen);
   bool applyPLT(codeGen &gen, CodeBuffer *buf);
+  bool applyDirect(codeGen &gen, int targetLabel, Address to);
 
 
 
@@ -75,6 +75,8 @@ struct InstWidgetPatch : public Patch {
   virtual ~InstWidgetPatch();
 
   baseTramp *tramp;
+  // Base tramp code depends only on where it is placed
+  PatchCache cache;
 };
 
 struct RemovedInstWidgetPatch : public Patch {
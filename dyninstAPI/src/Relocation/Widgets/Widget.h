@@ -34,6 +34,7 @@
 #include "common/src/Types.h" // Address
 #include "instructionAPI/h/Instruction.h" // Instruction::Ptr
 #include <list> // stl::list
+#include <vector>
 
 class baseTramp;
 class codeGen;
@@ -89,6 +90,30 @@ struct Patch {
    virtual ~Patch() {};
 };
 
+// CodeBuffer::generate re-applies every Patch on each pass until sizes
+// converge, but most Patches land at the same address (and target the
+// same place) as on the previous pass. A Patch whose output depends
+// only on those two addresses can keep a PatchCache and copy its last
+// result instead of generating it again.
+class PatchCache {
+  public:
+   PatchCache() : valid_(false), from_(0), to_(0) {};
+
+   // If we generated code at gen's current address for target to,
+   // copy it into gen and return true.
+   bool replay(codeGen &gen, Address to);
+   // Remember what was generated into gen since index start (which
+   // was at address from).
+   void record(codeGen &gen, unsigned start, Address from, Address to);
+   void invalidate() { valid_ = false; };
+
+  private:
+   bool valid_;
+   Address from_;
+   Address to_;
+   std::vector<unsigned char> bytes_;
+};
+
 
 };
 };
@@ -357,6 +357,12 @@ class AddressSpace : public InstructionSource {
     int_variable* trampGuardBase(void) { return trampGuardBase_; }
     AstNodePtr trampGuardAST(void);
 
+    // Offsets of the RT's static TLS tramp guard and thread index from
+    // the thread pointer, if the mutatee has published them; lets
+    // generated code use them inline instead of calling into the RT.
+    virtual bool getTrampGuardTLSOffset(long &) { return false; }
+    virtual bool getThreadIndexTLSOffset(long &) { return false; }
+
     // Get the current code generator (or emitter)
     Emitter *getEmitter();
 
@@ -519,6 +525,8 @@ class AddressSpace : public InstructionSource {
     /////// New instrumentation system
     typedef std::list<Relocation::CodeTracker *> CodeTrackers;
     CodeTrackers relocatedCode_;
+    // Address translation across all of relocatedCode_
+    Relocation::RelocIndex relocIndex_;
 
     bool transform(Dyninst::Relocation::CodeMoverPtr cm);
     Address generateCode(Dyninst::Relocation::CodeMoverPtr cm, Address near);
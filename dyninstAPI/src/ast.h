@@ -96,6 +96,7 @@ class image_variable;
 
 class AstNode;
 typedef boost::shared_ptr<AstNode> AstNodePtr;
+class AstOptimizer;
 class AstMiniTrampNode;
 typedef boost::shared_ptr<AstMiniTrampNode> AstMiniTrampNodePtr;
 
@@ -239,7 +240,19 @@ class AstNode : public Dyninst::PatchAPI::Snippet {
     // Acquire the thread index value - a 0...n labelling of threads.
    static AstNodePtr threadIndexNode();
 
+   // Zero-extended 32-bit load of the static TLS slot at tls_offset
+   // from the thread pointer.
+   static AstNodePtr tlsLoadNode(long tls_offset);
+
+   // Add amount to the word at addr; a locked add where the platform has
+   // one, otherwise a plain load/add/store.
+   static AstNodePtr atomicAddNode(AstNodePtr addr, long amount);
+
    static AstNodePtr scrambleRegistersNode();
+
+   // Inline tramp guard lock/unlock through the RT's static TLS slot at
+   // tls_offset from the thread pointer. The lock form yields the old value.
+   static AstNodePtr trampGuardNode(bool lock, long tls_offset);
    
    // TODO...
    // Needs some way of marking what to save and restore... should be a registerSpace, really
@@ -247,7 +260,6 @@ class AstNode : public Dyninst::PatchAPI::Snippet {
 #if 0
    static AstNodePtr saveStateNode();
    static AstNodePtr restoreStateNode();
-   static AstNodePtr trampGuardNode();
 #endif
 
    static AstNodePtr miniTrampNode(AstNodePtr tramp);
@@ -258,6 +270,12 @@ class AstNode : public Dyninst::PatchAPI::Snippet {
 
    static AstNodePtr snippetNode(Dyninst::PatchAPI::SnippetPtr snip);
 
+   // Fold constant arithmetic at the mutatee's address width and merge
+   // structurally equal subtrees that can be kept, so the pointer-based
+   // sharing above computes each of them once. The input is left intact;
+   // changed nodes are copied, and the (possibly new) root is returned.
+   static AstNodePtr optimize(AstNodePtr ast, unsigned addrWidth);
+
    AstNode(AstNodePtr src);
    //virtual AstNode &operator=(const AstNode &src);
         
@@ -529,6 +547,7 @@ class AstLabelNode : public AstNode {
 };
 
 class AstOperatorNode : public AstNode {
+    friend class AstOptimizer;
  public:
 
     AstOperatorNode(opCode opC, AstNodePtr l, AstNodePtr r = AstNodePtr(), AstNodePtr e = AstNodePtr());
@@ -824,6 +843,7 @@ class AstMiniTrampNode : public AstNode {
 };
 
 class AstMemoryNode : public AstNode {
+    friend class AstOptimizer;
  public:
     AstMemoryNode(memoryType mem, unsigned which, int size);
 	bool canBeKept() const;
@@ -919,6 +939,98 @@ class AstScrambleRegistersNode : public AstNode {
 };
 
 
+class AstTrampGuardNode : public AstNode {
+ public:
+    AstTrampGuardNode(bool lock, long tls_offset) :
+       lock_(lock), tls_offset_(tls_offset) {};
+
+    virtual ~AstTrampGuardNode() {};
+
+    virtual bool canBeKept() const { return false; }
+    virtual bool containsFuncCall() const;
+    virtual bool usesAppRegister() const;
+
+ private:
+    virtual bool generateCode_phase2(codeGen &gen,
+                                     bool noCost,
+                                     Address &retAddr,
+                                     Register &retReg);
+    bool lock_;
+    long tls_offset_;
+};
+
+class AstTLSLoadNode : public AstNode {
+ public:
+    AstTLSLoadNode(long tls_offset) : tls_offset_(tls_offset) {};
+
+    virtual ~AstTLSLoadNode() {};
+
+    virtual bool canBeKept() const { return false; }
+    virtual bool containsFuncCall() const;
+    virtual bool usesAppRegister() const;
+
+ private:
+    virtual bool generateCode_phase2(codeGen &gen,
+                                     bool noCost,
+                                     Address &retAddr,
+                                     Register &retReg);
+    long tls_offset_;
+};
+
+class AstAtomicAddNode : public AstNode {
+ public:
+    AstAtomicAddNode(AstNodePtr addr, long amount);
+
+    virtual ~AstAtomicAddNode() {};
+
+    virtual bool canBeKept() const { return false; }
+    virtual bool containsFuncCall() const;
+    virtual bool usesAppRegister() const;
+
+    virtual void getChildren(pdvector<AstNodePtr> &children);
+    virtual void setChildren(pdvector<AstNodePtr> &children);
+    virtual void setVariableAST(codeGen &gen);
+
+ private:
+    virtual bool generateCode_phase2(codeGen &gen,
+                                     bool noCost,
+                                     Address &retAddr,
+                                     Register &retReg);
+    AstNodePtr addr_;
+    long amount_;
+};
+
+// DYNINSTthreadIndex, specialized per address space at code generation.
+// When the RT has published the TLS slot caching the index we load it
+// inline and only call into the RT the first time a thread shows up.
+// The index can't change within a tramp, so the result is kept.
+class AstThreadIndexNode : public AstNode {
+ public:
+    AstThreadIndexNode() : as_(NULL), tls_offset_(0) {};
+
+    virtual ~AstThreadIndexNode() {};
+
+    virtual bool canBeKept() const { return true; }
+    virtual bool containsFuncCall() const;
+    virtual bool usesAppRegister() const { return false; }
+
+    virtual bool initRegisters(codeGen &gen);
+    virtual void setVariableAST(codeGen &gen);
+    virtual void getChildren(pdvector<AstNodePtr> &children);
+    virtual void setChildren(pdvector<AstNodePtr> &children);
+
+ private:
+    virtual bool generateCode_phase2(codeGen &gen,
+                                     bool noCost,
+                                     Address &retAddr,
+                                     Register &retReg);
+    void specialize(codeGen &gen);
+
+    AddressSpace *as_;
+    long tls_offset_;
+    AstNodePtr expansion_;
+};
+
 class AstSnippetNode : public AstNode {
    // This is a little odd, since an AstNode _is_
    // a Snippet. It's a compatibility interface to 
@@ -96,6 +96,9 @@ extern const std::string INST_GENERATE_COUNTER;
 extern const std::string INST_INSTALL_COUNTER;
 extern const std::string INST_LINK_COUNTER;
 extern const std::string INST_REMOVE_COUNTER;
+extern const std::string INST_SPRINGBOARD_BRANCH_COUNTER;
+extern const std::string INST_SPRINGBOARD_TRAP_COUNTER;
+extern const std::string INST_SPRINGBOARD_AVOIDED_COUNTER;
 
 extern const std::string PTRACE_WRITE_TIMER;
 extern const std::string PTRACE_WRITE_COUNTER;
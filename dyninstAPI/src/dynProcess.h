@@ -355,6 +355,9 @@ protected:
           sync_event_arg3_addr_(0),
           sync_event_breakpoint_addr_(0),
           rt_trap_func_addr_(0),
+          tramp_guard_tls_offset_(0),
+          thread_index_tls_offset_(0),
+          rt_tls_offsets_known_(false),
        thread_hash_tids(0),
        thread_hash_indices(0),
        thread_hash_size(0),
@@ -396,6 +399,9 @@ protected:
           sync_event_arg3_addr_(0),
           sync_event_breakpoint_addr_(0),
           rt_trap_func_addr_(0),
+          tramp_guard_tls_offset_(0),
+          thread_index_tls_offset_(0),
+          rt_tls_offsets_known_(false),
        thread_hash_tids(0),
        thread_hash_indices(0),
        thread_hash_size(0),
@@ -440,6 +446,9 @@ protected:
           sync_event_arg3_addr_(parent->sync_event_arg3_addr_),
           sync_event_breakpoint_addr_(parent->sync_event_breakpoint_addr_),
           rt_trap_func_addr_(parent->rt_trap_func_addr_),
+          tramp_guard_tls_offset_(parent->tramp_guard_tls_offset_),
+          thread_index_tls_offset_(parent->thread_index_tls_offset_),
+          rt_tls_offsets_known_(parent->rt_tls_offsets_known_),
        thread_hash_tids(parent->thread_hash_tids),
        thread_hash_indices(parent->thread_hash_indices),
        thread_hash_size(parent->thread_hash_size),
@@ -492,6 +501,10 @@ protected:
     Address getRTEventArg2Addr();
     Address getRTEventArg3Addr();
     Address getRTTrapFuncAddr();
+    bool getTrampGuardTLSOffset(long &offset);
+    bool getThreadIndexTLSOffset(long &offset);
+    bool readRTTLSOffsets();
+    long readRTTLSOffset(const char *name);
 
     // Shared library managment
     void addASharedObject(mapped_object *newObj);
@@ -598,6 +611,9 @@ protected:
     Address sync_event_arg3_addr_;
     Address sync_event_breakpoint_addr_;
     Address rt_trap_func_addr_;
+    long tramp_guard_tls_offset_;
+    long thread_index_tls_offset_;
+    bool rt_tls_offsets_known_;
     Address thread_hash_tids;
     Address thread_hash_indices;
     int thread_hash_size;
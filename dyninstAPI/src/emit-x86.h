@@ -244,6 +244,10 @@ public:
     bool emitBTSaves(baseTramp* bt, codeGen &gen);
     bool emitBTRestores(baseTramp* bt, codeGen &gen);
     void emitStoreImm(Address addr, int imm, codeGen &gen, bool noCost);
+    bool emitTrampGuardLock(Register dest, long tls_offset, codeGen &gen);
+    bool emitTrampGuardUnlock(long tls_offset, codeGen &gen);
+    bool emitLoadTLS(Register dest, long tls_offset, codeGen &gen);
+    bool emitAtomicAdd(Register addr, long amount, codeGen &gen);
     void emitAddSignedImm(Address addr, int imm, codeGen &gen, bool noCost);
     /* The DWARF register numbering does not correspond to the architecture's
        register encoding for 64-bit target binaries *only*. This method
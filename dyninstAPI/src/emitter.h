@@ -118,6 +118,15 @@ class Emitter {
 
     virtual bool emitTOCJump(block_instance *, codeGen &) { assert(0); return false; }
     virtual bool emitTOCCall(block_instance *, codeGen &) { assert(0); return false; }
+
+    // Inline tramp guard access through a static TLS offset.  Returning
+    // false means the platform can't, and the caller uses the RT calls.
+    virtual bool emitTrampGuardLock(Register, long, codeGen &) { return false; }
+    virtual bool emitTrampGuardUnlock(long, codeGen &) { return false; }
+    // Zero-extending 32-bit load of a static TLS slot into dest.
+    virtual bool emitLoadTLS(Register, long, codeGen &) { return false; }
+    // Atomically add an immediate to the word addressed by the register.
+    virtual bool emitAtomicAdd(Register, long, codeGen &) { return false; }
 };
 
 #endif
@@ -54,9 +54,8 @@ class trampTrapMappings {
    dyn_hash_map<Address, tramp_mapping_t> mapping;
    std::set<tramp_mapping_t *> updated_mappings;
 
-   static void arrange_mapping(tramp_mapping_t &m, bool should_sort,
-                               std::vector<tramp_mapping_t*> &mappings_to_add,
-                               std::vector<tramp_mapping_t*> &mappings_to_update);
+   static void arrange_mapping(tramp_mapping_t &m,
+                               std::vector<tramp_mapping_t*> &mappings_to_add);
 
    bool needs_updating;
    AddressSpace *as;
@@ -70,6 +69,14 @@ class trampTrapMappings {
                       unsigned addr_width);
    void writeTrampVariable(const int_variable *var, unsigned long val);
 
+   // Dynamic instrumentation keeps a hashed table in the mutatee, see
+   // DYNINST_TRAP_HASH.  slot_sources mirrors the source column so that we
+   // can probe without reading the mutatee.
+   std::vector<Address> slot_sources;
+   unsigned long findSlot(Address from) const;
+   void flushHashed();
+   void publishTable(unsigned long layout);
+
    unsigned long table_version;
    unsigned long table_used;
    unsigned long table_allocated;
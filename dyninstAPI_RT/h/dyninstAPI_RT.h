@@ -163,6 +163,17 @@ typedef struct {
    void *target;
 } trapMapping_t;
 
+/* Layouts of the dynamic trap table, stored in dyninstTrapTableIsSorted.
+ * For a hashed table dyninstTrapTableUsed holds the number of slots (a
+ * power of two); empty slots have a NULL source and collisions are
+ * resolved by linear probing from DYNINST_TRAP_HASH(source). */
+#define DYNINST_TRAP_TABLE_LINEAR 0
+#define DYNINST_TRAP_TABLE_SORTED 1
+#define DYNINST_TRAP_TABLE_HASHED 2
+
+#define DYNINST_TRAP_HASH(source, mask) \
+   ((unsigned long) ((((uint64_t) (source)) * 0x9E3779B97F4A7C15ULL) >> 32) & (mask))
+
 #define TRAP_HEADER_SIG 0x759191D6
 #define DT_DYNINST 0x6D191957
 
@@ -107,6 +107,7 @@ DLLEXPORT unsigned long RTtranslateMemory(unsigned long, unsigned long, unsigned
 DLLEXPORT unsigned long RTtranslateMemoryShift(unsigned long, unsigned long, unsigned long);
 DLLEXPORT void *DYNINSTos_malloc(size_t, void *, void *); 
 DLLEXPORT int DYNINSTloadLibrary(char *);
+DLLEXPORT int DYNINSTthreadIndex();
 
 /** 
  * And variables
@@ -145,6 +145,41 @@ DLLEXPORT void DYNINST_unlock_tramp_guard()
   DYNINST_tls_tramp_guard = 1;
 }
 
+// Thread indices are handed out densely, in the order threads first ask
+// for one, and cached in static TLS as index + 1 so that zero means "not
+// assigned yet".
+static TLS_VAR int DYNINST_tls_thread_index = 0;
+static int DYNINST_next_thread_index = 0;
+DECLARE_DYNINST_LOCK(DYNINST_thread_index_lock);
+
+DLLEXPORT int DYNINSTthreadIndex()
+{
+  if (!DYNINST_tls_thread_index) {
+    tc_lock_lock(&DYNINST_thread_index_lock);
+    DYNINST_tls_thread_index = ++DYNINST_next_thread_index;
+    tc_lock_unlock(&DYNINST_thread_index_lock);
+  }
+  return DYNINST_tls_thread_index - 1;
+}
+
+// Offsets of DYNINST_tls_tramp_guard and DYNINST_tls_thread_index from the
+// thread pointer.  Static TLS sits at the same offset in every thread, so
+// once these are published the mutator can access both inline instead of
+// calling the functions above.  Zero means unavailable and the mutator
+// falls back to the calls.
+DLLEXPORT long DYNINST_tramp_guard_tls_offset = 0;
+DLLEXPORT long DYNINST_thread_index_tls_offset = 0;
+
+static void initTLSOffsets()
+{
+#if !defined(_MSC_VER) && defined(__x86_64__) && defined(__linux__)
+   char *tp;
+   __asm__ ("mov %%fs:0, %0" : "=r" (tp));
+   DYNINST_tramp_guard_tls_offset = (char *) &DYNINST_tls_tramp_guard - tp;
+   DYNINST_thread_index_tls_offset = (char *) &DYNINST_tls_thread_index - tp;
+#endif
+}
+
 DECLARE_DYNINST_LOCK(DYNINST_trace_lock);
 
 /**
@@ -170,6 +205,7 @@ void DYNINSTBaseInit()
    DYNINSTinitializeTrapHandler();
 #endif
    DYNINST_unlock_tramp_guard();
+   initTLSOffsets();
    DYNINSThasInitialized = 1;
 
    RTuntranslatedEntryCounter = 0;
@@ -684,21 +720,44 @@ DLLEXPORT volatile unsigned long dyninstTrapTableVersion;
 DLLEXPORT volatile trapMapping_t *dyninstTrapTable;
 DLLEXPORT volatile unsigned long dyninstTrapTableIsSorted;
 
+/**
+ * Look up the instrumentation address for a trap at source.  The mutator
+ * makes the version odd while it replaces the table and even again once
+ * done, so retry if we raced with it.
+ **/
 void* dyninstTrapTranslate(void *source,
                            volatile unsigned long *table_used,
                            volatile unsigned long *table_version,
                            volatile trapMapping_t **trap_table,
                            volatile unsigned long *is_sorted)
 {
-   volatile unsigned local_version;
-   unsigned i;
+   volatile unsigned long local_version;
+   unsigned long i;
    void *target;
 
    do {
       local_version = *table_version;
       target = NULL;
+      if (local_version & 1)
+         continue;
 
-      if (*is_sorted)
+      if (*is_sorted == DYNINST_TRAP_TABLE_HASHED)
+      {
+         unsigned long mask = *table_used - 1;
+         unsigned long slot = DYNINST_TRAP_HASH((uintptr_t) source, mask);
+
+         for (i = 0; i <= mask; i++) {
+            volatile trapMapping_t *entry = &(*trap_table)[slot];
+            if (entry->source == source) {
+               target = entry->target;
+               break;
+            }
+            if (entry->source == NULL)
+               break;
+            slot = (slot + 1) & mask;
+         }
+      }
+      else if (*is_sorted)
       {
          unsigned min = 0;
          unsigned mid = 0;
@@ -733,7 +792,7 @@ void* dyninstTrapTranslate(void *source,
             }
          }
       }
-   } while (local_version != *table_version);
+   } while ((local_version & 1) || local_version != *table_version);
 
    return target;
 }
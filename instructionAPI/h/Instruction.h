@@ -180,6 +180,16 @@ namespace Dyninst
       /// involved are read but not written, regardless of the effect on the operand.
       INSTRUCTION_EXPORT void getReadSet(std::set<RegisterAST::Ptr>& regsRead) const;
 
+      /// \param regsWritten Insert the registers written by the instruction, including implicitly written
+      /// registers and flags, into \c regsWritten.
+      ///
+      /// This is the same set as the \c std::set version of \c getWriteSet, but it does not allocate
+      /// and is suitable for use in the inner loops of dataflow analyses.
+      INSTRUCTION_EXPORT void getWriteSet(RegisterBitSet& regsWritten) const;
+      /// \param regsRead Insert the registers read by the instruction, including implicitly read
+      /// registers and flags, into \c regsRead.
+      INSTRUCTION_EXPORT void getReadSet(RegisterBitSet& regsRead) const;
+
       /// \param candidate Subexpression to search for among the values read by this %Instruction object.
       ///
       /// Returns true if \c candidate is read by this %Instruction.
@@ -35,6 +35,7 @@
 #include "Register.h"
 #include "BinaryFunction.h"
 #include "Immediate.h"
+#include "RegisterBitSet.h"
 #include <set>
 #include <string>
 
@@ -97,6 +98,9 @@ namespace Dyninst
       /// \brief Get the registers written by this operand
       /// \param regsWritten Has the registers written  inserted into it
       INSTRUCTION_EXPORT void getWriteSet(std::set<RegisterAST::Ptr>& regsWritten) const;
+      /// \brief Allocation-free versions of \c getReadSet and \c getWriteSet
+      INSTRUCTION_EXPORT void getReadSet(RegisterBitSet& regsRead) const;
+      INSTRUCTION_EXPORT void getWriteSet(RegisterBitSet& regsWritten) const;
 
       /// Returns true if this operand is read
       INSTRUCTION_EXPORT bool isRead(Expression::Ptr candidate) const;
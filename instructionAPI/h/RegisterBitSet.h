@@ -0,0 +1,104 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(REGISTER_BIT_SET_H)
+#define REGISTER_BIT_SET_H
+
+#include <string.h>
+#include "dyn_regs.h"
+#include "util.h"
+
+namespace Dyninst
+{
+  namespace InstructionAPI
+  {
+    /// A %RegisterBitSet is a fixed-size set of registers of a single architecture.
+    /// Every named %MachRegister of an architecture has a small dense index, taken
+    /// from a static per-architecture table, so that membership, union, intersection
+    /// and difference are plain word operations that take no locks and allocate no
+    /// memory.  It is the allocation-free counterpart of the
+    /// \c std::set<RegisterAST::Ptr> returned by %Instruction::getReadSet and
+    /// %Instruction::getWriteSet.
+    ///
+    /// Registers are stored exactly as the decoder reports them: \c eax and \c rax, or
+    /// an individual flag bit and the whole flags register, are different members.
+    /// Use %MachRegister::getBaseRegister to fold sub-registers when iterating.
+    /// The one exception is Power: ppc64 registers are stored as their ppc32
+    /// equivalents, since the decoder mixes the two within an instruction.
+    class INSTRUCTION_EXPORT RegisterBitSet
+    {
+    public:
+      /// The largest number of distinct registers an architecture may have
+      static const unsigned int capacity = 1024;
+
+      RegisterBitSet() : arch(Arch_none) { clear(); }
+
+      /// Returns the dense index of \c r, or -1 if it is not a named register.
+      static int index(MachRegister r);
+      /// Returns the register with dense index \c i on architecture \c a
+      static MachRegister reg(Architecture a, int i);
+
+      void insert(MachRegister r);
+      void erase(MachRegister r);
+      bool contains(MachRegister r) const;
+
+      void clear() { memset(words, 0, sizeof(words)); }
+      bool empty() const;
+      unsigned int count() const;
+      Architecture getArch() const { return arch; }
+
+      /// Iterate over the members: \c first returns the lowest set index and
+      /// \c next the lowest set index after \c i, both -1 when there are none.
+      int first() const { return next(-1); }
+      int next(int i) const;
+      /// The register stored at index \c i of this set
+      MachRegister at(int i) const { return reg(arch, i); }
+
+      RegisterBitSet &operator|=(const RegisterBitSet &o);
+      RegisterBitSet &operator&=(const RegisterBitSet &o);
+      /// Removes every member of \c o from this set
+      RegisterBitSet &operator-=(const RegisterBitSet &o);
+      bool operator==(const RegisterBitSet &o) const;
+      bool operator!=(const RegisterBitSet &o) const { return !(*this == o); }
+      /// Returns true if this set and \c o have a member in common
+      bool intersects(const RegisterBitSet &o) const;
+
+    private:
+      static const unsigned int bits_per_word = 64;
+      static const unsigned int num_words = capacity / bits_per_word;
+      void merge_arch(Architecture a);
+
+      unsigned long long words[num_words];
+      Architecture arch;
+    };
+  };
+};
+
+#endif //!defined(REGISTER_BIT_SET_H)
@@ -82,6 +82,18 @@ class CFGModifier {
    // entry that function is returned; otherwise we create a new function and
    // return it.
    PARSER_EXPORT static Function *makeEntry(Block *);
+
+   // Re-parse the code in [start, end) of the given region after its
+   // bytes have been changed (the caller must update the backing store
+   // first). Blocks overlapping the range are torn down, as are functions
+   // whose entry was in the range (together with any of their blocks no
+   // other function shares); those functions are re-parsed under their
+   // original names and FuncSource, in-edges from surviving blocks are
+   // re-attached, and the rest of the CFG is left untouched. A summary of
+   // every destroyed and recreated block and edge is delivered through
+   // ParseCallback::reparse_cb.
+   PARSER_EXPORT static bool reparse(CodeObject *obj, CodeRegion *cr,
+                                     Address start, Address end);
 };
 
 class InsertedRegion : public CodeRegion {
@@ -54,6 +54,7 @@ class ParseCallback;
 class ParseCallbackManager;
 class CFGModifier;
 class CodeSource;
+class ParseExecutor;
 
 typedef enum {
     PreambleMatching, IdiomMatching
@@ -144,6 +145,14 @@ class CodeObject {
     PARSER_EXPORT void registerCallback(ParseCallback *cb);
     PARSER_EXPORT void unregisterCallback(ParseCallback *cb);
 
+    /*
+     * The scheduler parsing runs on. Defaults to
+     * ParseExecutor::getDefault(); the executor is not owned by the
+     * CodeObject and must outlive any parse it is used for.
+     */
+    PARSER_EXPORT void setExecutor(ParseExecutor *e);
+    PARSER_EXPORT ParseExecutor *executor() const;
+
     /*
      * Calling finalize() forces completion of all on-demand
      * parsing operations for this object, if any remain.
@@ -177,6 +186,7 @@ class CodeObject {
     CodeSource * _cs;
     CFGFactory * _fact;
     ParseCallbackManager * _pcb;
+    ParseExecutor * _executor;
 
     Parser * parser; // parser implementation
 
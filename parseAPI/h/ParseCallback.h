@@ -101,6 +101,32 @@ class ParseCallback {
      source, 
      target } edge_type_t;
 
+  /*
+   * Summary of an incremental re-parse (CFGModifier::reparse) of the
+   * address range [start, end). The individual block and edge changes
+   * are delivered through the callbacks below as they happen; removed
+   * blocks are reported by start address and removed edges by their
+   * endpoints since they have been destroyed. Both block lists include
+   * blocks outside the range that belonged to a function whose entry was
+   * in the range, since such functions are re-parsed whole; the edge
+   * lists cover every edge into or out of those blocks, plus the in-edges
+   * re-attached from surviving blocks.
+   */
+  struct reparse_details {
+    struct removed_edge {
+      Address source;
+      Address target;
+      EdgeTypeEnum type;
+    };
+    Address start;
+    Address end;
+    std::vector<Address> removed_blocks;
+    std::vector<Block *> added_blocks;
+    std::vector<removed_edge> removed_edges;
+    std::vector<Edge *> added_edges;
+    std::vector<Function *> modified_funcs;
+  };
+
   // Callbacks
   protected:
   virtual void interproc_cf(Function*,Block *,Address,interproc_details*) { }
@@ -156,6 +182,7 @@ class ParseCallback {
 
   virtual void modify_edge_cb(Edge *, Block *, ParseCallback::edge_type_t) {};
     virtual void function_discovery_cb(Function*) {};
+  virtual void reparse_cb(reparse_details *) {};
 
   private:
 };
@@ -206,6 +233,7 @@ class ParseCallbackManager {
   void foundWeirdInsns(Function*);
   void split_block_cb(Block *, Block *);
   void discover_function(Function*);
+  void reparse(ParseCallback::reparse_details *);
 
   private:
   // Named the same as ParseCallback to make the code
@@ -0,0 +1,86 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#ifndef _PARSE_EXECUTOR_H_
+#define _PARSE_EXECUTOR_H_
+
+#include <cstddef>
+#include <functional>
+
+#include "util.h"
+
+namespace Dyninst {
+namespace ParseAPI {
+
+/*
+ * The scheduler the parser runs on.
+ *
+ * Parsing is expressed as a root task that transitively spawns more tasks
+ * (one per parse frame) plus a handful of flat parallel loops. The default
+ * executor runs these on a TBB task arena, whose work-stealing scheduler
+ * keeps every worker busy regardless of how unevenly frames fan out.
+ * Embedders that already own a thread pool can supply their own executor
+ * instead, either globally (setDefault) or per CodeObject.
+ *
+ * Implementations must be thread safe: spawn() is called concurrently from
+ * tasks running on any worker.
+ */
+class PARSER_EXPORT ParseExecutor {
+ public:
+    typedef std::function<void()> Task;
+    typedef std::function<void(std::size_t)> Body;
+
+    virtual ~ParseExecutor() {}
+
+    // Run body(i) for every i in [0, n) and return when all have completed.
+    virtual void parallel_for(std::size_t n, const Body &body) = 0;
+
+    // Run root and every task it (transitively) spawns; return when all
+    // of them have completed.
+    virtual void run(const Task &root) = 0;
+
+    // Queue a task for execution; only valid from within run().
+    virtual void spawn(const Task &task) = 0;
+
+    // The executor used by CodeObjects that have not been given one. The
+    // default is a TBB executor sized by DYNINST_PARSE_THREADS (falling back
+    // to OMP_NUM_THREADS, then to the machine's concurrency); a value of 1
+    // selects the serial executor. Ownership is not transferred.
+    static ParseExecutor *getDefault();
+    static void setDefault(ParseExecutor *e);
+
+    // Built-in executors. Ownership passes to the caller.
+    static ParseExecutor *makeTBB(int threads = 0);
+    static ParseExecutor *makeSerial();
+};
+
+}
+}
+
+#endif
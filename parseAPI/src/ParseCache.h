@@ -0,0 +1,134 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * On-disk layout of the persistent CFG cache.  A cache file is a header
+ * followed by flat arrays of the records below, in the order they are
+ * declared, and then a string table.  Every record is a fixed-size POD so
+ * that a mapped cache file can be read in place.
+ */
+
+#ifndef _PARSE_CACHE_H_
+#define _PARSE_CACHE_H_
+
+#include <stdint.h>
+#include <string>
+
+namespace Dyninst {
+namespace ParseAPI {
+
+class CodeObject;
+
+namespace ParseCache {
+
+    // Bump whenever the layout below or the meaning of a field changes
+    static const uint32_t format_version = 1;
+    static const uint32_t no_index = 0xffffffff;
+    static const uint32_t endian_check = 0x01020304;
+
+    struct Header {
+        char magic[8];
+        uint32_t format;
+        uint32_t endian;
+        uint32_t dyninst_major;
+        uint32_t dyninst_minor;
+        uint32_t dyninst_patch;
+        uint32_t addr_width;
+        char build_id[64];
+        uint32_t num_regions;
+        uint32_t num_funcs;
+        uint32_t num_blocks;
+        uint32_t num_edges;
+        uint32_t num_jump_tables;
+        uint32_t num_jt_entries;
+        uint32_t strtab_size;
+        uint32_t pad;
+    };
+
+    struct RegionRecord {
+        uint64_t low;
+        uint64_t high;
+    };
+
+    struct FuncRecord {
+        uint64_t entry;
+        uint32_t region;
+        uint32_t name;          // offset into the string table
+        uint32_t entry_block;
+        uint8_t src;            // FuncSource
+        uint8_t retstatus;      // FuncReturnStatus
+        uint8_t pad[2];
+    };
+
+    struct BlockRecord {
+        uint64_t start;
+        uint64_t end;
+        uint64_t last;
+        uint32_t region;
+        uint32_t creator;       // function that owns the block on reload
+    };
+
+    struct EdgeRecord {
+        uint32_t src;
+        uint32_t trg;           // no_index for the sink block
+        uint8_t type;           // EdgeTypeEnum
+        uint8_t sink;
+        uint8_t interproc;
+        uint8_t pad[5];
+    };
+
+    struct JumpTableRecord {
+        uint64_t key;
+        uint64_t table_start;
+        uint64_t table_end;
+        uint32_t func;
+        uint32_t block;
+        int32_t index_stride;
+        int32_t memory_read_size;
+        uint32_t first_entry;
+        uint32_t num_entries;
+        uint8_t zero_extend;
+        uint8_t pad[7];
+    };
+
+    struct JumpTableEntryRecord {
+        uint64_t addr;
+        uint64_t target;
+    };
+
+    // Returns the cache file for this object, or an empty string if caching
+    // is disabled (DYNINST_PARSE_CACHE unset) or the object has no build-id.
+    std::string cachePath(CodeObject &obj);
+}
+
+}
+}
+
+#endif
@@ -267,6 +267,10 @@ namespace Dyninst {
 
             void invalidateContainingFuncs(Function *, Block *);
 
+            // persistent CFG cache, see ParseCache.C
+            bool load_cache(const std::string &path);
+            void store_cache(const std::string &path);
+
             bool getSyscallNumber(Function *, Block *, Address, Architecture, long int &);
 
             friend class CodeObject;
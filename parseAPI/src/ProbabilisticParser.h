@@ -110,6 +110,7 @@ struct Idiom {
 };
 
 class IdiomPrefixTree {
+    friend class IdiomAutomaton;
 public:
     typedef std::vector<std::pair<IdiomTerm, IdiomPrefixTree*> > ChildrenType;
     typedef dyn_hash_map<unsigned short, ChildrenType> ChildrenByEntryID;
@@ -132,6 +133,37 @@ public:
     const ChildrenType* getWildCardChildren();
 };
 
+// A read-only, flattened copy of an IdiomPrefixTree used for matching.
+// Nodes and idiom terms live in two contiguous arrays; each node's terms
+// are sorted by entry ID (wildcards included, under WILDCARD_ENTRY_ID),
+// so finding the terms that can match an instruction is one binary search
+// instead of a hash lookup per tree level.
+class IdiomAutomaton {
+public:
+    struct Edge {
+        IdiomTerm term;
+        unsigned target;
+    };
+    struct Node {
+        double w;
+        bool feature;
+        unsigned firstEdge;
+        unsigned numEdges;
+    };
+    typedef std::pair<const Edge*, const Edge*> EdgeRange;
+
+    void compile(IdiomPrefixTree *root);
+    static unsigned root() { return 0; }
+    const Node& node(unsigned n) const { return nodes[n]; }
+    EdgeRange edgesWithEntryID(unsigned n, unsigned short entry_id) const;
+    unsigned size() const { return nodes.size(); }
+
+private:
+    unsigned add(IdiomPrefixTree *tree);
+    std::vector<Node> nodes;
+    std::vector<Edge> edges;
+};
+
 class IdiomModel {
     IdiomPrefixTree normal;
     IdiomPrefixTree prefix;
@@ -171,14 +203,29 @@ class ProbabilityCalculator {
     
     dyn_hash_set<Function *> finalized;
 
-    // save the idiom extraction results for idiom matching at different addresses 
-    typedef dyn_hash_map<Address, DecodeData > DecodeCache;
-    DecodeCache decodeCache;
+    // Compiled forms of the model's normal and prefix idiom trees
+    IdiomAutomaton forward;
+    IdiomAutomaton backward;
+    // backwardMatched[n] == matchEpoch if prefix idiom node n has already
+    // contributed its weight at the address being scored
+    std::vector<unsigned> backwardMatched;
+    unsigned matchEpoch;
+
+    // save the idiom extraction results for idiom matching at different addresses.
+    // Gap scanning walks addresses in order and idiom matching only looks a
+    // few instructions to either side, so a direct-mapped window keeps
+    // nearly all the reuse while bounding memory regardless of gap size.
+    struct CachedDecode {
+        Address addr;
+        DecodeData data;
+    };
+    static const unsigned DecodeCacheBits = 12;
+    std::vector<CachedDecode> decodeCache;
 
     // Recursively mathcing normal idioms and calculate weights
-    double calcForwardWeights(int cur, Address addr, IdiomPrefixTree *tree, bool &valid);
+    double calcForwardWeights(int cur, Address addr, unsigned node, bool &valid);
     // Recursively mathcing prefix idioms and calculate weights
-    double calcBackwardWeights(int cur, Address addr, IdiomPrefixTree *tree, std::set<IdiomPrefixTree*> &matched);
+    double calcBackwardWeights(int cur, Address addr, unsigned node);
     // Enforce the overlapping constraints and
     // return true if the cur_addr doesn't conflict with other identified functions,
     // otherwise return false
@@ -205,6 +252,9 @@ public:
 		finalized.clear();
 	}
     double calcProbByMatchingIdioms(Address addr);
+    // The first address in [addr, end) that is not rejected outright as a
+    // function entry (zero or nop padding), or end if there is none
+    Address nextCandidate(Address addr, Address end);
     void calcProbByEnforcingConstraints();
     double getFEPProb(Address addr);
     bool isFEP(Address addr);
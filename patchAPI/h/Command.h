@@ -134,6 +134,33 @@ class PATCHAPI_EXPORT PushBackCommand : public Command {
     Dyninst::PatchAPI::InstancePtr instance_;
 };
 
+/* Insert one Snippet at many Points as a single Command, e.g., the result
+   of PatchMgr::findAllPoints. Undo removes every instance it added. */
+
+class PATCHAPI_EXPORT BulkInsertCommand : public Command {
+  public:
+    static BulkInsertCommand* create(const std::vector<Dyninst::PatchAPI::Point*> &pts,
+                      Dyninst::PatchAPI::SnippetPtr snip,
+                      bool front = false) {
+      return new BulkInsertCommand(pts, snip, front);
+    }
+    BulkInsertCommand(const std::vector<Dyninst::PatchAPI::Point*> &pts,
+                      Dyninst::PatchAPI::SnippetPtr snip,
+                      bool front)
+                      : pts_(pts), snip_(snip), front_(front) {}
+    virtual ~BulkInsertCommand() {}
+
+    virtual bool run();
+    virtual bool undo();
+    const std::vector<InstancePtr> &instances() const { return instances_; }
+
+  private:
+    std::vector<Dyninst::PatchAPI::Point*> pts_;
+    Dyninst::PatchAPI::SnippetPtr snip_;
+    bool front_;
+    std::vector<Dyninst::PatchAPI::InstancePtr> instances_;
+};
+
 class PATCHAPI_EXPORT RemoveSnippetCommand : public Command {
   public:
     static RemoveSnippetCommand* create(Dyninst::PatchAPI::InstancePtr instance) {
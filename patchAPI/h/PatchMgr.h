@@ -144,6 +144,15 @@ class PATCHAPI_EXPORT PatchMgr : public boost::enable_shared_from_this<PatchMgr>
                     OutputIterator output_iter,
                     bool create = true);
 
+    // Bulk interface: every point of the given types in an object, in a
+    // single walk over its functions. Block, edge, and instruction points
+    // are the per-function instances. Points are appended to a vector
+    // that is sized up front; there is no filter and no Candidates list.
+    bool findAllPoints(PatchObject *obj,
+                       Point::Type types,
+                       std::vector<Point *> &points,
+                       bool create = true);
+
     // Snippet instance removal
     // Return false if no point if found
     bool removeSnippet(InstancePtr);
@@ -228,6 +237,8 @@ class PATCHAPI_EXPORT PatchMgr : public boost::enable_shared_from_this<PatchMgr>
     void getInsnInstances(Scope &scope, InsnInstances &insns);
 
     void enumerateTypes(Point::Type types, EnumeratedTypes &out);
+    bool addPoint(Location loc, Point::Type type,
+                  std::vector<Point *> &points, bool create);
 
     bool match(Point *, Location *);
     bool verify(Location &loc);
@@ -472,6 +472,20 @@ class PC_EXPORT Process : public boost::enable_shared_from_this<Process>
    bool writeMemory(Dyninst::Address addr, const void *buffer, size_t size) const;
    bool readMemory(void *buffer, Dyninst::Address addr, size_t size) const;
 
+   /**
+    * Batched reads.  Reads every (addr, buffer, size) entry in one request,
+    * which on Linux is serviced with a handful of process_vm_readv calls
+    * rather than one syscall per range.  'err' is set per entry; the return
+    * value is false if any entry failed.
+    **/
+   struct read_t {
+      Dyninst::Address addr;
+      void *buffer;
+      size_t size;
+      err_t err;
+   };
+   bool readMemory(std::vector<read_t> &reads) const;
+
    bool writeMemoryAsync(Dyninst::Address addr, const void *buffer, size_t size, void *opaque_val = NULL) const;
    bool readMemoryAsync(void *buffer, Dyninst::Address addr, size_t size, void *opaque_val = NULL) const;
 
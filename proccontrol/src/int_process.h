@@ -432,6 +432,12 @@ class int_process
 
    virtual bool plat_readMem(int_thread *thr, void *local,
                              Dyninst::Address remote, size_t size) = 0;
+
+   //Batched synchronous reads.  The default plat_readMemBatch falls back to
+   // one plat_readMem per entry; platforms that can gather several remote
+   // ranges in one system call should override it.
+   bool readMemBatch(std::vector<Process::read_t> &reads, int_thread *thr = NULL);
+   virtual bool plat_readMemBatch(int_thread *thr, std::vector<Process::read_t> &reads);
    virtual bool plat_writeMem(int_thread *thr, const void *local,
                               Dyninst::Address remote, size_t size, bp_write_t bp_write) = 0;
 
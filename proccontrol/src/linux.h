@@ -133,6 +133,7 @@ class linux_process : public sysv_process, public unix_process, public thread_db
                              Dyninst::Address remote, size_t size);
    virtual bool plat_writeMem(int_thread *thr, const void *local,
                               Dyninst::Address remote, size_t size, bp_write_t bp_write);
+   virtual bool plat_readMemBatch(int_thread *thr, std::vector<Process::read_t> &reads);
    virtual SymbolReaderFactory *plat_defaultSymReader();
    virtual bool needIndividualThreadAttach();
    virtual bool getThreadLWPs(std::vector<Dyninst::LWP> &lwps);
@@ -158,6 +159,12 @@ class linux_process : public sysv_process, public unix_process, public thread_db
 
   protected:
    int computeAddrWidth();
+
+   //Cached /proc/<pid>/mem handle, opened lazily and reset across exec and fork.
+   int getMemFD();
+   void closeMemFD();
+   int mem_fd;
+   bool vm_readv_unsupported;
 };
 
 class linux_x86_process : public linux_process, public x86_process
@@ -37,6 +37,7 @@
 #include "basetypes.h"
 #include "dyn_regs.h"
 #include "PCProcess.h"
+#include "ProcessSet.h"
 
 
 #include <vector>
@@ -101,6 +102,11 @@ public:
   virtual bool preStackwalk(Dyninst::THR_ID tid);
   virtual bool postStackwalk(Dyninst::THR_ID tid);
 
+  //Bracket a batched walk of several threads (Walker::walkStacks).  The
+  //default calls preStackwalk/postStackwalk on each thread in turn.
+  virtual bool preStackwalkBatch(const std::vector<Dyninst::THR_ID> &tids);
+  virtual bool postStackwalkBatch(const std::vector<Dyninst::THR_ID> &tids);
+
   virtual bool isFirstParty() = 0;
 
   std::string getExecutablePath();
@@ -127,6 +133,11 @@ class SW_EXPORT ProcDebug : public ProcessState {
    ProcDebug(Dyninst::ProcControlAPI::Process::ptr p);
 
    std::set<Dyninst::ProcControlAPI::Thread::ptr> needs_resume;
+
+   //State for a batched stackwalk: the threads we stopped, and every
+   //register of every walked thread, read in one pass.
+   Dyninst::ProcControlAPI::ThreadSet::ptr batch_resume;
+   std::map<Dyninst::THR_ID, Dyninst::ProcControlAPI::RegisterPool> batch_regs;
  public:
   
   static ProcDebug *newProcDebug(Dyninst::PID pid, std::string executable="");
@@ -145,6 +156,8 @@ class SW_EXPORT ProcDebug : public ProcessState {
 
   virtual bool preStackwalk(Dyninst::THR_ID tid);
   virtual bool postStackwalk(Dyninst::THR_ID tid);
+  virtual bool preStackwalkBatch(const std::vector<Dyninst::THR_ID> &tids);
+  virtual bool postStackwalkBatch(const std::vector<Dyninst::THR_ID> &tids);
 
   
   virtual bool pause(Dyninst::THR_ID tid = NULL_THR_ID);
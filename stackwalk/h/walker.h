@@ -131,6 +131,13 @@ class SW_EXPORT Walker {
    bool walkStack(std::vector<Frame> &stackwalk, 
                   Dyninst::THR_ID thread = NULL_THR_ID);
 
+   //Collect stackwalks of several threads at once.  The process is stopped
+   //and registers are read once for the whole batch; stackwalks[i] holds
+   //the walk of threads[i].  Returns false if any walk failed, but still
+   //fills in the others.
+   bool walkStacks(const std::vector<Dyninst::THR_ID> &threads,
+                   std::vector<std::vector<Frame> > &stackwalks);
+
    //Collect a stackwalk starting at a certain frame
    bool walkStackFromFrame(std::vector<Frame> &stackwalk, 
                            const Frame &frame);
@@ -33,6 +33,7 @@
 
 #include "stackwalk/h/framestepper.h"
 #include "common/h/ProcReader.h"
+#include "common/h/concurrent.h"
 
 namespace Dyninst {
 
@@ -55,7 +56,15 @@ class DebugStepperImpl : public FrameStepper, public Dyninst::ProcessReader {
     cache_t(unsigned a, unsigned b, unsigned c) : ra_delta(a), fp_delta(b), sp_delta(c) {};
     };
 
-    dyn_hash_map<Address, cache_t> cache_;
+    // Caller-frame rules keyed by library-relative PC. The deltas are
+    // relative to the callee's SP, so they hold for every thread and every
+    // process mapping the same library; one concurrent cache per library
+    // is shared by all steppers.
+    typedef dyn_c_hash_map<Address, cache_t> frame_cache_t;
+    static frame_cache_t *getFrameCache(const std::string &lib);
+
+    frame_cache_t *cache_;     // Cache for the library of the current frame
+    Address cache_base_;       // and that library's load address
 
     void addToCache(const Frame &cur, const Frame &caller);
     bool lookupInCache(const Frame &cur, Frame &caller);
@@ -36,20 +36,29 @@
 #include "Serialization.h"
 #include "Annotatable.h"
 #include "Module.h"
+#include "concurrent.h"
+#include <atomic>
+#include <stdint.h>
+#include <boost/iterator/permutation_iterator.hpp>
 
 #define NEW_GETSOURCELINES_INTERFACE
 
 namespace Dyninst{
 namespace SymtabAPI{
 
-class SYMTAB_EXPORT LineInformation : 
-                        private RangeLookupTypes< Statement >::type
+/* Statements are kept in one vector sorted by [start, end); lookups search
+ * parallel column arrays (start, delta-encoded end, file, line) rather than
+ * the Statement objects themselves.  Source-order traversal goes through a
+ * permutation of that vector sorted by (file, line).  Lines added after the
+ * last lookup are merged in lazily by finalize(). */
+class SYMTAB_EXPORT LineInformation
 {
 public:
     typedef RangeLookupTypes< Statement> traits;
-    typedef RangeLookupTypes< Statement >::type impl_t;
-    typedef impl_t::index<Statement::addr_range>::type::const_iterator const_iterator;
-    typedef impl_t::index<Statement::line_info>::type::const_iterator const_line_info_iterator;
+    typedef std::vector<Statement::Ptr> rows_t;
+    typedef rows_t::const_iterator const_iterator;
+    typedef boost::permutation_iterator<const_iterator,
+                                        std::vector<unsigned>::const_iterator> const_line_info_iterator;
     typedef traits::value_type Statement_t;
       LineInformation();
 
@@ -90,6 +99,10 @@ public:
 
       unsigned getSize() const;
 
+      // Merge lines added since the last lookup into the sorted tables.
+      // Lookups do this on demand; parsers call it once a batch is done.
+      void finalize() const;
+
       void dump();
 
       virtual ~LineInformation();
@@ -101,6 +114,35 @@ public:
     void setStrings(StringTablePtr strings_);
 
 protected:
+    // Rows per entry of reach_
+    static const unsigned ReachStride = 64;
+    // lengths_ value for ranges that do not fit in 32 bits
+    static const uint32_t LongRange = 0xffffffffU;
+
+    Offset endOf(size_t i) const {
+        return (lengths_[i] != LongRange) ? starts_[i] + lengths_[i] : rows_[i]->endAddr();
+    }
+    size_t firstCandidate(Offset addr) const;
+    size_t pastCandidates(Offset addr) const;
+    std::pair<const_line_info_iterator, const_line_info_iterator>
+        sourceRange(unsigned fileIndex, const unsigned int *lineNo) const;
+    void buildColumns() const;
+
+    // rows_[0, sorted_) is ordered by [start, end); the rest is pending
+    mutable rows_t rows_;
+    mutable size_t sorted_;
+    mutable std::atomic<bool> dirty_;
+    mutable dyn_mutex finalize_lock_;
+
+    mutable std::vector<Offset> starts_;
+    mutable std::vector<uint32_t> lengths_;
+    mutable std::vector<unsigned> files_;
+    mutable std::vector<unsigned> lines_;
+    // reach_[b] is the largest end among rows [0, (b+1) * ReachStride)
+    mutable std::vector<Offset> reach_;
+    // Row numbers ordered by (file, line), then address
+    mutable std::vector<unsigned> byLine_;
+
     mutable int wasted_compares;
     mutable int num_queries;
 };
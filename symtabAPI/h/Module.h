@@ -257,6 +257,7 @@ namespace Dyninst{
 			void addRange(Dyninst::Address low, Dyninst::Address high);
 			bool hasRanges() const { return !ranges.empty() || ranges_finalized; }
 			void addDebugInfo(Module::DebugInfoT info);
+			void getDebugUnits(std::vector<Module::DebugInfoT> &units);
 
 			void finalizeRanges();
 
@@ -281,6 +282,13 @@ namespace Dyninst{
 
 		private:
 			bool ranges_finalized;
+			// All compilation units for this module; info_ is drained by
+			// line parsing, this is kept for on-demand type parsing.
+			dyn_c_vector<Module::DebugInfoT> units_;
+			bool unitTypesParsed_;
+			dyn_mutex unitTypesLock_;
+
+			void parseTypesIfNecessary();
 
 			void finalizeOneRange(Address ext_s, Address ext_e) const;
 		};
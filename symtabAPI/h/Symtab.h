@@ -238,6 +238,8 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    /*****Query Functions*****/
    bool isExec() const;
    bool isStripped();
+   // Hex-encoded contents of the GNU build-id note, if the object has one
+   bool getBuildID(std::string &id);
    ObjectType getObjectType() const;
    Dyninst::Architecture getArchitecture() const;
    bool isCode(const Offset where) const;
@@ -0,0 +1,125 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(SYMTAB_INDEX_H)
+#define SYMTAB_INDEX_H
+
+#include <string>
+#include <vector>
+
+#include "symutil.h"
+#include "Symbol.h"
+
+class MappedFile;
+
+namespace Dyninst {
+namespace SymtabAPI {
+
+class Symtab;
+
+/*
+ * A SymtabIndex is a read-only, memory-mapped summary of a Symtab: its
+ * symbols, function entry points, line table and module ranges, laid out
+ * as sorted flat arrays.  Tools that repeatedly open the same objects can
+ * write an index once with SymtabIndex::write and later answer symbol,
+ * function and line lookups from the mapping without opening the Symtab
+ * or parsing DWARF.  Results point into the mapping and remain valid for
+ * the lifetime of the SymtabIndex.
+ */
+class SYMTAB_EXPORT SymtabIndex
+{
+ public:
+   struct SymbolEntry {
+      const char *mangledName;
+      const char *prettyName;
+      Offset offset;
+      unsigned long size;
+      Symbol::SymbolType type;
+      Symbol::SymbolLinkage linkage;
+   };
+
+   struct FunctionEntry {
+      const char *name;
+      Offset offset;
+      unsigned long size;
+   };
+
+   struct LineEntry {
+      const char *file;
+      unsigned int line;
+      unsigned int column;
+      Offset startAddr;
+      Offset endAddr;
+   };
+
+   struct ModuleEntry {
+      const char *name;
+      Offset low;
+      Offset high;
+   };
+
+   // Writes an index for obj, parsing line information if necessary
+   static bool write(Symtab *obj, const std::string &path);
+
+   // Maps an index.  If build_id is non-empty the index must have been
+   // written for an object with that build-id.
+   static SymtabIndex *open(const std::string &path,
+                            const std::string &build_id = std::string());
+
+   // $DYNINST_SYMTAB_INDEX/<build-id>.dsi, or empty if the variable is
+   // unset or obj has no build-id
+   static std::string defaultPath(Symtab *obj);
+
+   ~SymtabIndex();
+
+   const char *buildID() const;
+
+   bool findSymbol(std::vector<SymbolEntry> &ret,
+                   const std::string &name,
+                   Symbol::SymbolType sType = Symbol::ST_UNKNOWN,
+                   NameType nameType = anyName) const;
+   bool getContainingFunction(Offset offset, FunctionEntry &func) const;
+   bool getSourceLines(std::vector<LineEntry> &lines, Offset addressInRange) const;
+   bool findModuleByOffset(ModuleEntry &mod, Offset offset) const;
+   bool isCode(Offset offset) const;
+
+ private:
+   SymtabIndex(MappedFile *mf);
+   bool validate(const std::string &build_id);
+
+   struct Layout;
+   MappedFile *mf_;
+   Layout *layout_;
+};
+
+}
+}
+
+#endif
@@ -257,6 +257,7 @@ class stab_entry_64 : public stab_entry {
 // end of stab declarations
 
 class pdElfShdr;
+class DwarfTypeState;
 class Symtab;
 class Region;
 class Object;
@@ -285,6 +286,8 @@ public:
   void parseFileLineInfo();
   
   void parseTypeInfo();
+  // Parse the types of just the compilation units belonging to mod.
+  void parseTypeInfoForModule(Module *mod);
 
   bool needs_function_binding() const { return (plt_addr_ > 0); } 
   bool get_func_binding_table(std::vector<relocationEntry> &fbt) const;
@@ -477,6 +480,8 @@ public:
   public:
   Dyninst::DwarfDyninst::DwarfHandle::ptr dwarf;
   private:
+  // Shared by the whole-object and per-module DWARF type walks.
+  boost::shared_ptr<DwarfTypeState> dwarf_type_state;
 
   bool      EEL;                 // true if EEL rewritten
   bool 	    did_open;		// true if the file has been mmapped
@@ -530,6 +535,9 @@ private:
     void parseLineInfoForCU(Module::DebugInfoT cuDIE, LineInformation* li);
     
     LineInformation* li_for_object;
+    // Modules without CUs of their own share li_for_object, and their line
+    // info may be parsed concurrently; this serializes building it.
+    dyn_mutex li_for_object_lock;
     LineInformation* parseLineInfoForObject(StringTablePtr strings);
     bool dwarf_parse_aranges(::Dwarf *dbg, std::set<Dwarf_Off>& dies_seen);
 
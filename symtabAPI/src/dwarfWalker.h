@@ -201,6 +201,24 @@ struct ContextGuard {
     ~ContextGuard() { c.pop(); }
 };
 
+/*
+ * State shared by every walker over the same Dwarf handle. Type IDs are
+ * assigned by DIE offset here so that compilation units parsed on different
+ * threads, or lazily at different times, agree on them; parsed_units makes
+ * sure each unit is walked exactly once.
+ */
+struct DwarfTypeState {
+    typedef boost::shared_ptr<DwarfTypeState> ptr;
+
+    dyn_c_hash_map<Dwarf_Off, typeId_t> info_type_ids; // .debug_info offset -> id
+    dyn_c_hash_map<Dwarf_Off, typeId_t> types_type_ids; // .debug_types offset -> id
+    dyn_c_hash_map<uint64_t, typeId_t> sig8_type_ids;
+    dyn_c_hash_map<uint64_t, Dwarf_Off> sig8_units; // signature -> .debug_types unit DIE
+    dyn_c_hash_map<Dwarf_Off, bool> parsed_units; // by .debug_info offset
+    dyn_c_hash_map<Dwarf_Off, bool> parsed_type_units; // by .debug_types offset
+    std::once_flag sig8_once;
+};
+
 class DwarfWalker : public DwarfParseActions {
 
 public:
@@ -209,7 +227,8 @@ public:
 
     } Error;
 
-    DwarfWalker(Symtab *symtab, Dwarf* dbg);
+    DwarfWalker(Symtab *symtab, Dwarf* dbg,
+                DwarfTypeState::ptr state = DwarfTypeState::ptr());
 
     DwarfWalker(const DwarfWalker& o) :
             DwarfParseActions(o),
@@ -228,9 +247,11 @@ public:
             typeoffset(o.typeoffset),
             next_cu_header(o.next_cu_header),
             compile_offset(o.compile_offset),
+            state_(o.state_),
             info_type_ids_(o.info_type_ids_),
             types_type_ids_(o.types_type_ids_),
-            sig8_type_ids_(o.sig8_type_ids_) {}
+            sig8_type_ids_(o.sig8_type_ids_),
+            track_sig8_refs_(false) {}
 
     virtual ~DwarfWalker();
 
@@ -239,6 +260,11 @@ public:
     // Takes current debug state as represented by dbg_;
     bool parseModule(Dwarf_Die is_info, Module *&fixUnknownMod);
 
+    // Parse the given compilation units of a single Module unless some
+    // walker sharing our state already has, along with the type units their
+    // DW_FORM_ref_sig8 references need, then fix up the Module's types.
+    bool parseUnits(Module *target, const std::vector<Dwarf_Die> &units);
+
     // Non-recursive version of parse
     // A Context must be provided as an _input_ to this function,
     // whereas parse creates a context.
@@ -406,15 +432,26 @@ private:
     Dwarf_Off compile_offset;
 
     // Type IDs are just int, but Dwarf_Off is 64-bit and may be relative to
-    // either .debug_info or .debug_types.
-    dyn_c_hash_map<Dwarf_Off, typeId_t> info_type_ids_; // .debug_info offset -> id
-    dyn_c_hash_map<Dwarf_Off, typeId_t> types_type_ids_; // .debug_types offset -> id
+    // either .debug_info or .debug_types. The maps live in the shared state.
+    DwarfTypeState::ptr state_;
+    dyn_c_hash_map<Dwarf_Off, typeId_t> &info_type_ids_; // .debug_info offset -> id
+    dyn_c_hash_map<Dwarf_Off, typeId_t> &types_type_ids_; // .debug_types offset -> id
 
     typeId_t get_type_id(Dwarf_Off offset, bool is_info);
     typeId_t type_id(); // get_type_id() for the current entry
 
     // Map to connect DW_FORM_ref_sig8 to type IDs.
-    dyn_c_hash_map<uint64_t, typeId_t> sig8_type_ids_;
+    dyn_c_hash_map<uint64_t, typeId_t> &sig8_type_ids_;
+
+    // Claim a unit for this walker; false if it has already been parsed.
+    bool claimUnit(Dwarf_Die &unit);
+
+    // Signatures referenced while parsing, when track_sig8_refs_ is set.
+    bool track_sig8_refs_;
+    std::set<uint64_t> sig8_refs_;
+
+    bool parseTypeUnit(Dwarf_Die unit, Module *target);
+    bool fixupModuleTypes(Module *m);
 
     bool parseModuleSig8(bool is_info);
     void findAllSig8Types();